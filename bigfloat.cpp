@@ -0,0 +1,236 @@
+#include "bigfloat.hpp"
+#include <algorithm>
+
+// round man * 2^exp to prec bits
+// sticky means that the exact value is a little larger than man * 2^exp, below any bit of man
+bigfloat bigfloat::make(bool sign, natural man, exponent_t exp, bool sticky, int prec, rounding_mode rnd) {
+    assert (1 <= prec);
+    bigfloat n = zero(prec);
+    if (not man) { assert (not sticky); return n; }
+    int l = man.bit_length();
+    if (sticky and l < prec + 2) { // make room for the guard bits
+        man <<= prec + 2 - l;
+        exp -= prec + 2 - l;
+        l = prec + 2;
+    }
+    if (prec < l) {
+        int k = l - prec;
+        natural q = man >> k;
+        natural r = man - (q << k);
+        bool inexact = r or sticky;
+        bool up = false;
+        switch (rnd) {
+            case round_to_nearest: {
+                natural half = natural(1) << (k-1);
+                up = half < r or (half == r and (sticky or q.count_trailing_zeros() == 0));
+                break;
+            }
+            case round_toward_zero: break;
+            case round_upward:   up = inexact and not sign; break;
+            case round_downward: up = inexact and sign; break;
+        }
+        if (up) ++ q;
+        man = q;
+        exp += k;
+    }
+    int z = man.count_trailing_zeros();
+    n.sign = sign;
+    n.man = man >> z;
+    n.exp = exp + z;
+    assert (n.valid());
+    return n;
+}
+
+bigfloat::bigfloat(integer const & n, int prec_, rounding_mode rnd) {
+    *this = make(n < integer(), abs(n).to_natural(), 0, false, prec_, rnd);
+}
+bigfloat::bigfloat(rational const & n, int prec_, rounding_mode rnd) {
+    *this = divide(n < rational(), abs(n.numerator()).to_natural(), 0, n.denominator(), 0, prec_, rnd);
+}
+bigfloat bigfloat::zero(int prec) {
+    assert (1 <= prec);
+    bigfloat n;
+    n.prec = prec;
+    return n;
+}
+bigfloat bigfloat::exact(integer const & n) {
+    return bigfloat(n, std::max(1, abs(n).to_natural().bit_length()));
+}
+
+int bigfloat::compare_abs(bigfloat const & a, bigfloat const & b) {
+    if (not a.man or not b.man) return (a.man ? 1 : 0) - (b.man ? 1 : 0);
+    exponent_t at = a.exp + a.man.bit_length();
+    exponent_t bt = b.exp + b.man.bit_length();
+    if (at != bt) return at < bt ? -1 : 1;
+    exponent_t e = std::min(a.exp, b.exp);
+    natural am = a.man << (a.exp - e);
+    natural bm = b.man << (b.exp - e);
+    return am == bm ? 0 : am < bm ? -1 : 1;
+}
+
+bigfloat bigfloat::add(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd) {
+    if (not b.man) return make(a.sign, a.man, a.exp, false, prec, rnd);
+    if (not a.man) return make(b.sign, b.man, b.exp, false, prec, rnd);
+    bigfloat const & x = compare_abs(a, b) < 0 ? b : a; // the larger
+    bigfloat const & y = compare_abs(a, b) < 0 ? a : b;
+    natural ym = y.man;
+    exponent_t ye = y.exp;
+    // if y is entirely below both the last bit of x and the rounding position, only its sign matters
+    exponent_t p = std::min(x.exp, x.exp + x.man.bit_length() - prec - 2);
+    if (ye + ym.bit_length() <= p) {
+        ym = natural(1);
+        ye = p - 1;
+    }
+    exponent_t e = std::min(x.exp, ye);
+    natural xm = x.man << (x.exp - e);
+    ym <<= ye - e;
+    if (x.sign == y.sign) {
+        return make(x.sign, xm + ym, e, false, prec, rnd);
+    } else {
+        return make(x.sign, xm - ym, e, false, prec, rnd);
+    }
+}
+bigfloat bigfloat::sub(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd) {
+    return add(a, - b, prec, rnd);
+}
+bigfloat bigfloat::mul(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd) {
+    return make(a.sign != b.sign, a.man * b.man, a.exp + b.exp, false, prec, rnd);
+}
+bigfloat bigfloat::divide(bool sign, natural const & a, exponent_t ea, natural const & b, exponent_t eb, int prec, rounding_mode rnd) {
+    assert (b);
+    if (not a) return zero(prec);
+    // take enough bits of the quotient for the guard bits
+    int s = std::max(0, prec + 2 + b.bit_length() - a.bit_length());
+    auto q = natural::divmod(a << s, b);
+    return make(sign, q.first, ea - s - eb, bool(q.second), prec, rnd);
+}
+bigfloat bigfloat::div(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd) {
+    return divide(a.sign != b.sign, a.man, a.exp, b.man, b.exp, prec, rnd);
+}
+bigfloat bigfloat::sqrt(bigfloat const & a, int prec, rounding_mode rnd) {
+    assert (not a.sign);
+    if (not a.man) return zero(prec);
+    int s = std::max(0, 2 * (prec + 2) - a.man.bit_length());
+    if ((a.exp - s) % 2 != 0) ++ s;
+    natural m = a.man << s;
+    natural r = ::sqrt(m);
+    return make(false, r, (a.exp - s) / 2, r * r != m, prec, rnd);
+}
+bigfloat bigfloat::round(bigfloat const & a, int prec, rounding_mode rnd) {
+    return make(a.sign, a.man, a.exp, false, prec, rnd);
+}
+
+bigfloat & bigfloat::operator += (bigfloat const & n) {
+    return *this = add(*this, n, std::max(prec, n.prec));
+}
+bigfloat & bigfloat::operator -= (bigfloat const & n) {
+    return *this = sub(*this, n, std::max(prec, n.prec));
+}
+bigfloat & bigfloat::operator *= (bigfloat const & n) {
+    return *this = mul(*this, n, std::max(prec, n.prec));
+}
+bigfloat & bigfloat::operator /= (bigfloat const & n) {
+    return *this = div(*this, n, std::max(prec, n.prec));
+}
+bigfloat operator + (bigfloat const & a, bigfloat const & b) {
+    return bigfloat::add(a, b, std::max(a.prec, b.prec));
+}
+bigfloat operator - (bigfloat const & a) {
+    bigfloat n = a;
+    n.sign = a.man and not a.sign;
+    return n;
+}
+bigfloat operator - (bigfloat const & a, bigfloat const & b) {
+    return bigfloat::sub(a, b, std::max(a.prec, b.prec));
+}
+bigfloat operator * (bigfloat const & a, bigfloat const & b) {
+    return bigfloat::mul(a, b, std::max(a.prec, b.prec));
+}
+bigfloat operator / (bigfloat const & a, bigfloat const & b) {
+    return bigfloat::div(a, b, std::max(a.prec, b.prec));
+}
+bigfloat sqrt(bigfloat const & a) {
+    return bigfloat::sqrt(a, a.prec);
+}
+bigfloat abs(bigfloat const & a) {
+    bigfloat n = a;
+    n.sign = false;
+    return n;
+}
+
+bool operator == (bigfloat const & a, bigfloat const & b) {
+    assert (a.valid());
+    assert (b.valid());
+    return a.sign == b.sign and a.exp == b.exp and a.man == b.man;
+}
+bool operator != (bigfloat const & a, bigfloat const & b) {
+    return not (a == b);
+}
+bool operator <= (bigfloat const & a, bigfloat const & b) {
+    if (a.sign != b.sign) return a.sign;
+    int c = bigfloat::compare_abs(a, b);
+    return a.sign ? 0 <= c : c <= 0;
+}
+bool operator <  (bigfloat const & a, bigfloat const & b) {
+    return a != b and a <= b;
+}
+bool operator >= (bigfloat const & a, bigfloat const & b) {
+    return not (a < b);
+}
+bool operator >  (bigfloat const & a, bigfloat const & b) {
+    return not (a <= b);
+}
+bigfloat::operator bool () const {
+    return bool(man);
+}
+
+int bigfloat::precision() const {
+    return prec;
+}
+integer bigfloat::trunc() const {
+    return integer(sign, 0 <= exp ? man << exp : man >> - exp);
+}
+rational bigfloat::to_rational() const {
+    if (0 <= exp) return rational(integer(sign, man << exp));
+    return rational(integer(sign, man), integer(natural(1) << - exp));
+}
+
+// t * 10^n, with a pass over t for each 9 decimal digits, as 10^9 fits in a digit_t
+static natural & multiply_pow10(natural & t, int n) {
+    for (; n >= 9; n -= 9) t *= 1000000000;
+    uint64_t r = 1;
+    for (; n > 0; -- n) r *= 10;
+    return t *= r;
+}
+std::string bigfloat::to_string(int n) const {
+    assert (0 <= n);
+    natural t = 0 <= exp ? man << exp : man;
+    multiply_pow10(t, n);
+    if (exp < 0) t >>= - exp;
+    std::string s = t.to_string();
+    if (s.size() < n + 1) s = std::string(n + 1 - s.size(), '0') + s;
+    if (n) s.insert(s.end() - n, '.');
+    return (sign and t ? "-" : "") + s; // no sign for what is truncated to zero
+}
+std::string bigfloat::to_string() const {
+    // as many significant digits as the precision, roughly
+    exponent_t top = man ? exp + man.bit_length() : 0;
+    return to_string(std::max<exponent_t>(0, (prec - top) * 30103 / 100000 + 1));
+}
+std::experimental::optional<bigfloat> bigfloat::from_string(std::string const & s, int prec, rounding_mode rnd) {
+    using namespace std::experimental;
+    size_t i = s.find('.');
+    if (i == std::string::npos) {
+        optional<integer> n = integer::from_string(s);
+        return n ? optional<bigfloat>(bigfloat(*n, prec, rnd)) : optional<bigfloat>();
+    }
+    std::string fraction = s.substr(i+1);
+    optional<integer> n = integer::from_string(s.substr(0, i) + fraction);
+    if (i == 0 or s.substr(0, i) == "-" or fraction.empty() or not n) return optional<bigfloat>();
+    natural d = natural(1);
+    multiply_pow10(d, fraction.size());
+    return optional<bigfloat>(bigfloat(rational(*n, integer(d)), prec, rnd));
+}
+std::ostream & operator << (std::ostream & output, bigfloat const & n) {
+    return output << n.to_string();
+}
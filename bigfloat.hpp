@@ -0,0 +1,78 @@
+#pragma once
+#include "integer.hpp"
+#include "rational.hpp"
+
+// thanks to:
+// - http://www.mpfr.org/mpfr-current/mpfr.html
+
+// a binary floating-point number (-1)^sign * man * 2^exp, with arbitrary precision
+// each operation is rounded correctly to the given precision, with respect to the given rounding mode
+// the operators use the larger precision of the operands and round_to_nearest
+class bigfloat {
+public:
+    typedef long long exponent_t;
+    enum rounding_mode {
+        round_to_nearest, // ties to even
+        round_toward_zero,
+        round_upward,
+        round_downward,
+    };
+    static const int default_precision = 64; // bits
+
+public:
+    bigfloat() : sign(false), man(), exp(0), prec(default_precision) {}
+    explicit bigfloat(integer const & n, int prec_ = default_precision, rounding_mode rnd = round_to_nearest);
+    explicit bigfloat(rational const & n, int prec_ = default_precision, rounding_mode rnd = round_to_nearest);
+    static bigfloat zero(int prec);
+    static bigfloat exact(integer const & n); // with the precision of the bit length of n, without rounding
+#ifdef NDEBUG
+    ~bigfloat() = default; // non virtual
+#else
+    ~bigfloat() { assert (valid()); }
+#endif
+public:
+    static bigfloat add(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd = round_to_nearest);
+    static bigfloat sub(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd = round_to_nearest);
+    static bigfloat mul(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd = round_to_nearest);
+    static bigfloat div(bigfloat const & a, bigfloat const & b, int prec, rounding_mode rnd = round_to_nearest);
+    static bigfloat sqrt(bigfloat const & a, int prec, rounding_mode rnd = round_to_nearest);
+    static bigfloat round(bigfloat const & a, int prec, rounding_mode rnd = round_to_nearest);
+    bigfloat & operator += (bigfloat const & n);
+    bigfloat & operator -= (bigfloat const & n);
+    bigfloat & operator *= (bigfloat const & n);
+    bigfloat & operator /= (bigfloat const & n);
+    friend bigfloat operator + (bigfloat const & a, bigfloat const & b);
+    friend bigfloat operator - (bigfloat const & a);
+    friend bigfloat operator - (bigfloat const & a, bigfloat const & b);
+    friend bigfloat operator * (bigfloat const & a, bigfloat const & b);
+    friend bigfloat operator / (bigfloat const & a, bigfloat const & b);
+    friend bigfloat sqrt(bigfloat const & a);
+    friend bigfloat abs(bigfloat const & a);
+    friend bool operator == (bigfloat const & a, bigfloat const & b);
+    friend bool operator != (bigfloat const & a, bigfloat const & b);
+    friend bool operator <= (bigfloat const & a, bigfloat const & b);
+    friend bool operator <  (bigfloat const & a, bigfloat const & b);
+    friend bool operator >= (bigfloat const & a, bigfloat const & b);
+    friend bool operator >  (bigfloat const & a, bigfloat const & b);
+    explicit operator bool () const;
+    int precision() const;
+    integer trunc() const;
+    rational to_rational() const;
+    std::string to_string(int n) const; // with n fractional decimal digits, truncated
+    std::string to_string() const;
+    static std::experimental::optional<bigfloat> from_string(std::string const & s, int prec = default_precision, rounding_mode rnd = round_to_nearest);
+    friend std::ostream & operator << (std::ostream & output, bigfloat const & n);
+private:
+    static bigfloat make(bool sign, natural man, exponent_t exp, bool sticky, int prec, rounding_mode rnd);
+    static bigfloat divide(bool sign, natural const & a, exponent_t ea, natural const & b, exponent_t eb, int prec, rounding_mode rnd);
+    static int compare_abs(bigfloat const & a, bigfloat const & b); // -1, 0, 1
+    bool valid() const {
+        if (not man) return sign == false and exp == 0;
+        return man.bit_length() <= prec and man.count_trailing_zeros() == 0;
+    }
+private:
+    bool sign; // is_negative
+    natural man; // odd, or zero
+    exponent_t exp;
+    int prec;
+};
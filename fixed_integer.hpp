@@ -0,0 +1,131 @@
+#pragma once
+#include "fixed_natural.hpp"
+#include "integer.hpp"
+
+// a signed integer of fixed width, as a sign and a fixed_natural<Bits> magnitude
+// the magnitude wraps around modulo 2^Bits on overflow
+template <int Bits>
+class fixed_integer {
+public:
+    constexpr fixed_integer() : sign(false), nat() {}
+    constexpr /* implicit */ fixed_integer(fixed_natural<Bits> const & n_) : sign(false), nat(n_) {}
+    constexpr fixed_integer(bool sign_, fixed_natural<Bits> const & n_) : sign(sign_), nat(n_) { normalize(); }
+    constexpr explicit fixed_integer(int64_t n_) : sign(n_ < 0), nat(n_ < 0 ? - (uint64_t) n_ : n_) {}
+    explicit fixed_integer(integer const & n_) : sign(n_ < integer()), nat(abs(n_).to_natural()) { normalize(); }
+    integer to_integer() const {
+        return integer(sign, nat.to_natural());
+    }
+
+public:
+    constexpr fixed_integer & operator ++ () {
+        return *this += fixed_integer(1);
+    }
+    constexpr fixed_integer & operator -- () {
+        return *this -= fixed_integer(1);
+    }
+    constexpr fixed_integer operator ++ (int) {
+        fixed_integer n = *this;
+        ++ (*this);
+        return n;
+    }
+    constexpr fixed_integer operator -- (int) {
+        fixed_integer n = *this;
+        -- (*this);
+        return n;
+    }
+    constexpr fixed_integer & operator += (fixed_integer const & n) {
+        if (sign == n.sign) {
+            nat += n.nat;
+        } else {
+            if (nat >= n.nat) {
+                nat -= n.nat;
+            } else {
+                sign = n.sign;
+                nat = n.nat - nat;
+            }
+        }
+        normalize();
+        return *this;
+    }
+    constexpr fixed_integer & operator -= (fixed_integer const & n) {
+        return *this += fixed_integer(not n.sign, n.nat);
+    }
+    constexpr fixed_integer & operator *= (fixed_integer const & n) {
+        nat *= n.nat;
+        sign = sign != n.sign;
+        normalize();
+        return *this;
+    }
+    friend constexpr fixed_integer operator + (fixed_integer const & a, fixed_integer const & b) {
+        fixed_integer c = a;
+        c += b;
+        return c;
+    }
+    friend constexpr fixed_integer operator - (fixed_integer const & a) {
+        return fixed_integer(not a.sign, a.nat);
+    }
+    friend constexpr fixed_integer operator - (fixed_integer const & a, fixed_integer const & b) {
+        fixed_integer c = a;
+        c -= b;
+        return c;
+    }
+    friend constexpr fixed_integer operator * (fixed_integer const & a, fixed_integer const & b) {
+        fixed_integer c = a;
+        c *= b;
+        return c;
+    }
+    friend constexpr fixed_integer operator / (fixed_integer const & a, fixed_integer const & b) { // truncated, as integer
+        return fixed_integer(a.sign != b.sign, a.nat / b.nat);
+    }
+    friend constexpr fixed_integer operator % (fixed_integer const & a, fixed_integer const & b) { // has the sign of a
+        return fixed_integer(a.sign, a.nat % b.nat);
+    }
+    friend constexpr bool operator == (fixed_integer const & a, fixed_integer const & b) {
+        return a.sign == b.sign and a.nat == b.nat;
+    }
+    friend constexpr bool operator != (fixed_integer const & a, fixed_integer const & b) {
+        return a.sign != b.sign or a.nat != b.nat;
+    }
+    friend constexpr bool operator <= (fixed_integer const & a, fixed_integer const & b) {
+        if (a.sign == b.sign) {
+            if (not a.sign) {
+                return a.nat <= b.nat;
+            } else {
+                return b.nat <= a.nat;
+            }
+        } else {
+            return a.sign;
+        }
+    }
+    friend constexpr bool operator <  (fixed_integer const & a, fixed_integer const & b) {
+        return a != b and a <= b;
+    }
+    friend constexpr bool operator >= (fixed_integer const & a, fixed_integer const & b) {
+        return not (a < b);
+    }
+    friend constexpr bool operator >  (fixed_integer const & a, fixed_integer const & b) {
+        return not (a <= b);
+    }
+    constexpr explicit operator bool () const {
+        return bool(nat);
+    }
+    friend constexpr fixed_integer abs(fixed_integer const & n) {
+        return fixed_integer(n.nat);
+    }
+    constexpr fixed_natural<Bits> to_natural() const {
+        return nat;
+    }
+    std::string to_string() const {
+        return (sign ? "-" : "") + nat.to_string();
+    }
+    friend std::ostream & operator << (std::ostream & output, fixed_integer const & n) {
+        return output << n.to_string();
+    }
+private:
+    constexpr void normalize() {
+        if (not nat) sign = false;
+    }
+private:
+    bool sign; // is_negative
+    fixed_natural<Bits> nat;
+};
@@ -0,0 +1,235 @@
+#pragma once
+#include "natural.hpp"
+#include <utility>
+
+// a natural number of fixed width, without heap allocation
+// arithmetic wraps around modulo 2^Bits, as the builtin unsigned types do
+// the digits are a raw array rather than std::array, to be mutable in constexpr functions of C++14
+template <int Bits>
+class fixed_natural {
+public:
+    typedef natural::digit_t digit_t;
+    typedef natural::double_digit_t double_digit_t;
+    static const int digit_digits = natural::digit_digits;
+    static const int size = Bits / digit_digits;
+    static_assert (0 < Bits and Bits % natural::digit_digits == 0, "Bits must be a positive multiple of the width of digit_t");
+
+public:
+    constexpr fixed_natural() : digits() {}
+    constexpr explicit fixed_natural(uint64_t n) : digits() {
+        for (int i = 0; i < size and n; ++i) {
+            digits[i] = natural::low_digit(n);
+            n = natural::high_digit(n);
+        }
+    }
+    explicit fixed_natural(natural const & n) : digits() { // truncated modulo 2^Bits
+        for (int i = 0; i < size and i < n.digits.size(); ++i) {
+            digits[i] = n.digits[i];
+        }
+    }
+    natural to_natural() const {
+        return natural(natural::digits_t(digits, digits + size));
+    }
+
+public:
+    constexpr fixed_natural & operator ++ () {
+        for (int i = 0; i < size; ++i) {
+            digits[i] += 1;
+            if (digits[i] != 0) break;
+        }
+        return *this;
+    }
+    constexpr fixed_natural & operator -- () {
+        for (int i = 0; i < size; ++i) {
+            digits[i] -= 1;
+            if (digits[i] != natural::digit_max) break;
+        }
+        return *this;
+    }
+    constexpr fixed_natural operator ++ (int) {
+        fixed_natural n = *this;
+        ++ (*this);
+        return n;
+    }
+    constexpr fixed_natural operator -- (int) {
+        fixed_natural n = *this;
+        -- (*this);
+        return n;
+    }
+    constexpr fixed_natural & operator += (fixed_natural const & b) {
+        digit_t carry = 0;
+        for (int i = 0; i < size; ++i) {
+            double_digit_t t = (double_digit_t) digits[i] + b.digits[i] + carry;
+            digits[i] = natural::low_digit(t);
+            carry = natural::high_digit(t);
+        }
+        return *this;
+    }
+    constexpr fixed_natural & operator -= (fixed_natural const & b) {
+        digit_t borrow = 0;
+        for (int i = 0; i < size; ++i) {
+            double_digit_t t = (double_digit_t) digits[i] - b.digits[i] - borrow;
+            digits[i] = natural::low_digit(t);
+            borrow = natural::high_digit(t) ? 1 : 0;
+        }
+        return *this;
+    }
+    constexpr fixed_natural & operator *= (fixed_natural const & b) {
+        return *this = *this * b;
+    }
+    constexpr fixed_natural & operator /= (fixed_natural const & b) {
+        return *this = divmod(*this, b).first;
+    }
+    constexpr fixed_natural & operator %= (fixed_natural const & b) {
+        return *this = divmod(*this, b).second;
+    }
+    friend constexpr fixed_natural operator + (fixed_natural const & a, fixed_natural const & b) {
+        fixed_natural c = a;
+        c += b;
+        return c;
+    }
+    friend constexpr fixed_natural operator - (fixed_natural const & a, fixed_natural const & b) {
+        fixed_natural c = a;
+        c -= b;
+        return c;
+    }
+    friend constexpr fixed_natural operator * (fixed_natural const & a, fixed_natural const & b) {
+        // schoolbook, the digits above 2^Bits are not computed
+        fixed_natural c;
+        for (int i = 0; i < size; ++i) {
+            if (a.digits[i] == 0) continue;
+            digit_t carry = 0;
+            for (int j = 0; i + j < size; ++j) {
+                double_digit_t t = (double_digit_t) a.digits[i] * b.digits[j] + c.digits[i+j] + carry; // does not overflow
+                c.digits[i+j] = natural::low_digit(t);
+                carry = natural::high_digit(t);
+            }
+        }
+        return c;
+    }
+    static constexpr std::pair<fixed_natural,fixed_natural> divmod(fixed_natural const & a, fixed_natural const & b);
+    friend constexpr fixed_natural operator / (fixed_natural const & a, fixed_natural const & b) {
+        return divmod(a, b).first;
+    }
+    friend constexpr fixed_natural operator % (fixed_natural const & a, fixed_natural const & b) {
+        return divmod(a, b).second;
+    }
+    friend constexpr bool operator == (fixed_natural const & a, fixed_natural const & b) {
+        for (int i = 0; i < size; ++i) {
+            if (a.digits[i] != b.digits[i]) return false;
+        }
+        return true;
+    }
+    friend constexpr bool operator != (fixed_natural const & a, fixed_natural const & b) {
+        return not (a == b);
+    }
+    friend constexpr bool operator <= (fixed_natural const & a, fixed_natural const & b) {
+        for (int i = size-1; 0 <= i; --i) {
+            if (a.digits[i] != b.digits[i]) {
+                return a.digits[i] < b.digits[i];
+            }
+        }
+        return true; // equal
+    }
+    friend constexpr bool operator <  (fixed_natural const & a, fixed_natural const & b) {
+        return not (b <= a);
+    }
+    friend constexpr bool operator >= (fixed_natural const & a, fixed_natural const & b) {
+        return b <= a;
+    }
+    friend constexpr bool operator >  (fixed_natural const & a, fixed_natural const & b) {
+        return not (a <= b);
+    }
+    constexpr explicit operator bool () const {
+        for (int i = 0; i < size; ++i) {
+            if (digits[i]) return true;
+        }
+        return false;
+    }
+    std::string to_string() const {
+        return to_natural().to_string();
+    }
+    friend std::ostream & operator << (std::ostream & output, fixed_natural const & n) {
+        return output << n.to_string();
+    }
+private:
+    constexpr int length() const { // the number of significant digits
+        int l = size;
+        while (l and digits[l-1] == 0) --l;
+        return l;
+    }
+    static constexpr int count_leading_zeros(digit_t a) {
+        int k = 0;
+        for (digit_t mask = natural::digit_max ^ (natural::digit_max >> 1); mask and not (a & mask); mask >>= 1) ++k;
+        return k;
+    }
+private:
+    digit_t digits[size];
+};
+
+template <int Bits>
+constexpr std::pair<fixed_natural<Bits>,fixed_natural<Bits> > fixed_natural<Bits>::divmod(fixed_natural const & a, fixed_natural const & b) {
+    assert (b);
+    const int n = b.length();
+    const int m = a.length();
+    if (a < b) return std::make_pair(fixed_natural(), a);
+    fixed_natural q;
+    fixed_natural r;
+    if (n == 1) {
+        double_digit_t t = 0;
+        for (int i = m-1; 0 <= i; --i) {
+            t = natural::to_high_digit(t) + a.digits[i];
+            q.digits[i] = t / b.digits[0];
+            t %= b.digits[0];
+        }
+        r.digits[0] = t;
+        return std::make_pair(q, r);
+    }
+    // Knuth's algorithm D, with the divisor normalized to have its highest bit set
+    const int s = count_leading_zeros(b.digits[n-1]);
+    digit_t u[size + 1] = {};
+    digit_t v[size] = {};
+    for (int i = 0; i < n; ++i) {
+        v[i] = (double_digit_t) b.digits[i] << s;
+        if (s and i) v[i] |= b.digits[i-1] >> (digit_digits - s);
+    }
+    for (int i = 0; i <= m; ++i) {
+        if (i < m) u[i] = (double_digit_t) a.digits[i] << s;
+        if (s and i) u[i] |= a.digits[i-1] >> (digit_digits - s);
+    }
+    for (int j = m - n; 0 <= j; --j) {
+        const double_digit_t t = natural::to_high_digit(u[j+n]) + u[j+n-1];
+        double_digit_t qhat = t / v[n-1];
+        double_digit_t rhat = t % v[n-1];
+        while (qhat >= natural::radix or qhat * v[n-2] > natural::to_high_digit(rhat) + u[j+n-2]) {
+            -- qhat;
+            rhat += v[n-1];
+            if (rhat >= natural::radix) break;
+        }
+        // u -= qhat * v
+        digit_t borrow = 0;
+        digit_t carry = 0;
+        for (int i = 0; i <= n; ++i) {
+            double_digit_t p = qhat * (i < n ? v[i] : 0) + carry;
+            carry = natural::high_digit(p);
+            double_digit_t d = (double_digit_t) u[i+j] - natural::low_digit(p) - borrow;
+            u[i+j] = natural::low_digit(d);
+            borrow = natural::high_digit(d) ? 1 : 0;
+        }
+        if (borrow) { // qhat was too large by one
+            -- qhat;
+            digit_t c = 0;
+            for (int i = 0; i <= n; ++i) {
+                double_digit_t d = (double_digit_t) u[i+j] + (i < n ? v[i] : 0) + c;
+                u[i+j] = natural::low_digit(d);
+                c = natural::high_digit(d);
+            }
+        }
+        q.digits[j] = qhat;
+    }
+    for (int i = 0; i < n; ++i) {
+        r.digits[i] = u[i] >> s;
+        if (s) r.digits[i] |= (double_digit_t) u[i+1] << (digit_digits - s);
+    }
+    return std::make_pair(q, r);
+}
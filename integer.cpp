@@ -32,22 +32,26 @@ integer   integer::operator -- (int) {
     -- (*this);
     return n;
 }
-integer & integer::operator += (integer const & n) {
-    if (sign == n.sign) {
-        nat += n.nat;
+template <typename T>
+integer & integer::add(bool n_sign, T const & n_nat) {
+    if (sign == n_sign) {
+        nat += n_nat;
     } else {
-        if (nat >= n.nat) {
-            nat -= n.nat;
+        if (nat >= n_nat) {
+            nat -= n_nat;
         } else {
-            sign = n.sign;
-            nat = n.nat - nat;
+            sign = n_sign;
+            nat.subtract_from(n_nat);
         }
         normalize();
     }
     return *this;
 }
+integer & integer::operator += (integer const & n) {
+    return add(n.sign, n.nat);
+}
 integer & integer::operator -= (integer const & n) {
-    return *this += integer(not n.sign, n.nat);
+    return add(not n.sign, n.nat);
 }
 integer & integer::operator *= (integer const & n) {
     nat *= n.nat;
@@ -75,10 +79,108 @@ integer operator * (integer const & a, integer const & b) {
     c *= b;
     return c;
 }
+integer & integer::operator /= (integer const & n) {
+    return *this = divmod(*this, n).first;
+}
+integer & integer::operator %= (integer const & n) {
+    return *this = divmod(*this, n).second;
+}
+integer & integer::operator += (int64_t n) {
+    return add(n < 0, magnitude(n));
+}
+integer & integer::operator -= (int64_t n) {
+    return add(not (n < 0), magnitude(n));
+}
+integer & integer::operator *= (int64_t n) {
+    nat *= magnitude(n);
+    sign = sign != (n < 0);
+    normalize();
+    return *this;
+}
+integer & integer::operator /= (int64_t n) {
+    nat /= magnitude(n);
+    sign = sign != (n < 0);
+    normalize();
+    return *this;
+}
+integer & integer::operator %= (int64_t n) {
+    nat %= magnitude(n);
+    normalize();
+    return *this;
+}
+std::pair<integer,integer> integer::divmod(integer const & a, integer const & b) {
+    auto p = natural::divmod(a.nat, b.nat);
+    return std::make_pair(integer(a.sign != b.sign, p.first), integer(a.sign, p.second));
+}
+std::pair<integer,integer> integer::floor_divmod(integer const & a, integer const & b) {
+    auto p = divmod(a, b);
+    if (p.second and a.sign != b.sign) {
+        -- p.first;
+        p.second += b;
+    }
+    return p;
+}
+std::pair<integer,integer> integer::ceil_divmod(integer const & a, integer const & b) {
+    auto p = divmod(a, b);
+    if (p.second and a.sign == b.sign) {
+        ++ p.first;
+        p.second -= b;
+    }
+    return p;
+}
+std::pair<integer,integer> integer::euclidean_divmod(integer const & a, integer const & b) {
+    auto p = divmod(a, b);
+    if (p.second.sign) {
+        if (not b.sign) {
+            -- p.first;
+            p.second += b;
+        } else {
+            ++ p.first;
+            p.second -= b;
+        }
+    }
+    return p;
+}
 integer operator / (integer const & a, integer const & b) {
-    integer n = integer(a.sign != b.sign, a.nat / b.nat);
-    n.normalize();
-    return n;
+    return integer::divmod(a, b).first;
+}
+integer operator % (integer const & a, integer const & b) {
+    return integer::divmod(a, b).second;
+}
+integer operator + (integer const & a, int64_t b) {
+    integer c = a;
+    c += b;
+    return c;
+}
+integer operator + (int64_t a, integer const & b) {
+    return b + a;
+}
+integer operator - (integer const & a, int64_t b) {
+    integer c = a;
+    c -= b;
+    return c;
+}
+integer operator - (int64_t a, integer const & b) {
+    integer c = - b;
+    c += a;
+    return c;
+}
+integer operator * (integer const & a, int64_t b) {
+    integer c = a;
+    c *= b;
+    return c;
+}
+integer operator * (int64_t a, integer const & b) {
+    return b * a;
+}
+integer operator / (integer const & a, int64_t b) {
+    integer c = a;
+    c /= b;
+    return c;
+}
+int64_t operator % (integer const & a, int64_t b) {
+    uint64_t r = a.nat % integer::magnitude(b); // < 2^63
+    return a.sign ? - (int64_t) r : r;
 }
 bool operator == (integer const & a, integer const & b) {
     assert (a.valid());
@@ -112,13 +214,61 @@ bool operator >= (integer const & a, integer const & b) {
 bool operator >  (integer const & a, integer const & b) {
     return not (a <= b);
 }
+bool operator == (integer const & a, int64_t b) {
+    return a.sign == (b < 0) and a.nat == integer::magnitude(b);
+}
+bool operator != (integer const & a, int64_t b) {
+    return not (a == b);
+}
+bool operator <= (integer const & a, int64_t b) {
+    if (a.sign != (b < 0)) return a.sign;
+    return a.sign ? a.nat >= integer::magnitude(b) : a.nat <= integer::magnitude(b);
+}
+bool operator <  (integer const & a, int64_t b) {
+    return a != b and a <= b;
+}
+bool operator >= (integer const & a, int64_t b) {
+    return not (a < b);
+}
+bool operator >  (integer const & a, int64_t b) {
+    return not (a <= b);
+}
+bool operator == (int64_t a, integer const & b) {
+    return b == a;
+}
+bool operator != (int64_t a, integer const & b) {
+    return b != a;
+}
+bool operator <= (int64_t a, integer const & b) {
+    return b >= a;
+}
+bool operator <  (int64_t a, integer const & b) {
+    return b >  a;
+}
+bool operator >= (int64_t a, integer const & b) {
+    return b <= a;
+}
+bool operator >  (int64_t a, integer const & b) {
+    return b <  a;
+}
 integer::operator bool () const {
     assert (valid());
     return not not nat;
 }
 
+bool integer::fits_int() const {
+    return sign
+        ? nat <= (uint64_t) std::numeric_limits<long long int>::max() + 1
+        : nat.fits_int();
+}
 long long int integer::to_int() const {
-    return (sign ? -1 : 1) * nat.to_int();
+#ifdef NDEBUG
+    if (not fits_int()) return sign ? std::numeric_limits<long long int>::min() : std::numeric_limits<long long int>::max();
+#else
+    assert (fits_int());
+#endif
+    if (not sign) return nat.to_int();
+    return - (long long int) (nat - 1).to_int() - 1; // -2^63 does not overflow
 }
 integer abs(integer const & n) {
     return integer(n.nat);
@@ -147,7 +297,7 @@ std::istream & operator >> (std::istream & input, integer & n) {
     input >> s;
     if (not input.fail()) {
         auto t = integer::from_string(s);
-        n = t ? *t : integer(0);
+        n = t ? *t : integer();
         if (not t) input.setstate(std::ios::failbit);
     }
     return input;
@@ -6,7 +6,7 @@ public:
     integer() : sign(false), nat() {}
     /* implicit */ integer(natural const & n_) : sign(false), nat(n_) {}
     integer(bool sign_, natural const & n_) : sign(sign_), nat(n_) { normalize(); }
-    explicit integer(natural::digit_t n_) : sign(false), nat(natural(n_)) {}
+    explicit integer(int64_t n_) : sign(n_ < 0), nat(n_ < 0 ? - (uint64_t) n_ : n_) {}
 #ifdef NDEBUG
     ~integer() = default; // non virtual
 #else
@@ -20,19 +20,52 @@ public:
     integer & operator += (integer const & n);
     integer & operator -= (integer const & n);
     integer & operator *= (integer const & n);
+    integer & operator /= (integer const & n);
+    integer & operator %= (integer const & n);
+    integer & operator += (int64_t n);
+    integer & operator -= (int64_t n);
+    integer & operator *= (int64_t n);
+    integer & operator /= (int64_t n);
+    integer & operator %= (int64_t n);
     friend integer operator + (integer const & a, integer const & b);
     friend integer operator - (integer const & a);
     friend integer operator - (integer const & a, integer const & b);
     friend integer operator * (integer const & a, integer const & b);
-    friend integer operator / (integer const & a, integer const & b);
+    static std::pair<integer,integer> divmod(integer const & a, integer const & b); // truncated, the remainder has the sign of a
+    static std::pair<integer,integer> floor_divmod(integer const & a, integer const & b); // the remainder has the sign of b
+    static std::pair<integer,integer> ceil_divmod(integer const & a, integer const & b); // the remainder has the opposite sign of b
+    static std::pair<integer,integer> euclidean_divmod(integer const & a, integer const & b); // the remainder is non-negative
+    friend integer operator / (integer const & a, integer const & b); // truncated
+    friend integer operator % (integer const & a, integer const & b);
+    friend integer operator + (integer const & a, int64_t b);
+    friend integer operator + (int64_t a, integer const & b);
+    friend integer operator - (integer const & a, int64_t b);
+    friend integer operator - (int64_t a, integer const & b);
+    friend integer operator * (integer const & a, int64_t b);
+    friend integer operator * (int64_t a, integer const & b);
+    friend integer operator / (integer const & a, int64_t b); // truncated
+    friend int64_t operator % (integer const & a, int64_t b);
     friend bool operator == (integer const & a, integer const & b);
     friend bool operator != (integer const & a, integer const & b);
     friend bool operator <= (integer const & a, integer const & b);
     friend bool operator <  (integer const & a, integer const & b);
     friend bool operator >= (integer const & a, integer const & b);
     friend bool operator >  (integer const & a, integer const & b);
+    friend bool operator == (integer const & a, int64_t b);
+    friend bool operator != (integer const & a, int64_t b);
+    friend bool operator <= (integer const & a, int64_t b);
+    friend bool operator <  (integer const & a, int64_t b);
+    friend bool operator >= (integer const & a, int64_t b);
+    friend bool operator >  (integer const & a, int64_t b);
+    friend bool operator == (int64_t a, integer const & b);
+    friend bool operator != (int64_t a, integer const & b);
+    friend bool operator <= (int64_t a, integer const & b);
+    friend bool operator <  (int64_t a, integer const & b);
+    friend bool operator >= (int64_t a, integer const & b);
+    friend bool operator >  (int64_t a, integer const & b);
     explicit operator bool () const;
-    long long int to_int() const;
+    bool fits_int() const;
+    long long int to_int() const; // requires fits_int()
     friend integer abs(integer const & n);
     natural to_natural() const;
     std::string to_string() const;
@@ -40,6 +73,8 @@ public:
     friend std::istream & operator >> (std::istream & input, integer & n);
     friend std::ostream & operator << (std::ostream & output, integer const & n);
 private:
+    template <typename T> integer & add(bool n_sign, T const & n_nat); // T is natural or uint64_t
+    static uint64_t magnitude(int64_t n) { return n < 0 ? - (uint64_t) n : n; }
     bool valid() const {
         return nat != natural(0) or sign == false;
     }
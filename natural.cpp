@@ -78,6 +78,25 @@ natural & natural::operator -= (natural const & bn) {
     normalize();
     return *this;
 }
+natural & natural::subtract_from(natural const & bn) {
+#ifdef NDEBUG
+    if (bn <= *this) { digits.clear(); return *this; }
+#else
+    assert (*this <= bn);
+#endif
+    natural::digits_t & a = digits;
+    natural::digits_t const & b = bn.digits;
+    a.resize(b.size());
+    natural::digit_t borrow = 0;
+    for (int i = 0; i < b.size(); ++i) {
+        natural::double_digit_t t = (natural::double_digit_t) b[i] - a[i] - borrow;
+        a[i] = natural::low_digit(t);
+        borrow = natural::high_digit(t) ? 1 : 0;
+    }
+    assert (borrow == 0);
+    normalize();
+    return *this;
+}
 natural & natural::operator *= (natural const & n) {
     return *this = *this * n;
 }
@@ -94,27 +113,149 @@ natural operator - (natural const & a, natural const & b) {
     return c;
 }
 
-natural & natural::operator *= (digit_t b) {
+// kernels for a machine integer, at most two digits
+natural & natural::operator += (uint64_t b) {
     natural::digits_t & a = digits;
-    natural::digit_t overflow = 0;
-    for (int i = 0; i < a.size(); ++i) {
-        natural::double_digit_t t = (natural::double_digit_t) a[i] * b + overflow;
-        assert ((natural::double_digit_t) a[i] * b <= t); // t itself does not overflow
-        a[i] = t;
-        overflow = natural::high_digit(t);
+    if (a.size() < 2) a.resize(2);
+    natural::double_digit_t t = (natural::double_digit_t) a[0] + natural::low_digit(b);
+    a[0] = natural::low_digit(t);
+    t = (natural::double_digit_t) a[1] + natural::high_digit(b) + natural::high_digit(t);
+    a[1] = natural::low_digit(t);
+    if (natural::high_digit(t)) {
+        int i = 2;
+        for (; i < a.size(); ++i) {
+            a[i] += 1;
+            if (a[i] != 0) break;
+        }
+        if (i == a.size()) a.push_back(1);
     }
-    if (overflow) {
-        a.resize(a.size() + 1);
-        a.back() = overflow;
+    normalize();
+    return *this;
+}
+natural & natural::operator -= (uint64_t b) {
+    if (b == 0) return *this;
+#ifdef NDEBUG
+    if (*this <= b) { digits.clear(); return *this; }
+#else
+    assert (*this >= b);
+#endif
+    natural::digits_t & a = digits;
+    natural::double_digit_t t = (natural::double_digit_t) a[0] - natural::low_digit(b);
+    a[0] = natural::low_digit(t);
+    natural::digit_t borrow = natural::high_digit(t) ? 1 : 0;
+    if (1 < a.size()) {
+        t = (natural::double_digit_t) a[1] - natural::high_digit(b) - borrow;
+        a[1] = natural::low_digit(t);
+        borrow = natural::high_digit(t) ? 1 : 0;
+        for (int i = 2; borrow; ++i) {
+            assert (i < a.size());
+            borrow = a[i] == 0;
+            a[i] -= 1;
+        }
     }
-    assert (valid());
+    normalize();
     return *this;
 }
-natural operator * (natural const & a, natural::digit_t b) {
+natural & natural::subtract_from(uint64_t b) {
+#ifdef NDEBUG
+    if (*this >= b) { digits.clear(); return *this; }
+#else
+    assert (*this <= b);
+#endif
+    uint64_t a = to_uint64();
+    digits.clear();
+    return *this += b - a;
+}
+natural & natural::operator *= (uint64_t b) {
+    natural::digits_t & a = digits;
+    if (a.empty()) return *this;
+    if (b == 0) { a.clear(); return *this; }
+    const natural::digit_t b0 = natural::low_digit(b);
+    const natural::digit_t b1 = natural::high_digit(b);
+    natural::digit_t c0 = 0;
+    natural::digit_t c1 = 0;
+    natural::digit_t prev = 0; // a[i-1] before it is overwritten
+    const int l = a.size();
+    a.resize(l + 2);
+    for (int i = 0; i < l + 2; ++i) {
+        natural::double_digit_t t0 = (natural::double_digit_t) a[i] * b0 + c0; // does not overflow
+        natural::double_digit_t t1 = (natural::double_digit_t) prev * b1 + natural::low_digit(t0) + c1; // neither
+        prev = a[i];
+        a[i] = natural::low_digit(t1);
+        c0 = natural::high_digit(t0);
+        c1 = natural::high_digit(t1);
+    }
+    assert (c0 == 0 and c1 == 0);
+    normalize();
+    return *this;
+}
+natural::digit_t natural::divide_digit(digit_t b) {
+    assert (b != 0);
+    natural::digits_t & a = digits;
+    natural::double_digit_t t = 0;
+    for (int i = a.size() - 1; 0 <= i; --i) {
+        t = natural::to_high_digit(t) + a[i];
+        a[i] = t / b;
+        t %= b;
+    }
+    normalize();
+    return t;
+}
+natural & natural::operator /= (uint64_t b) {
+    if (natural::high_digit(b) == 0) {
+        divide_digit(b);
+        return *this;
+    }
+    return *this = natural::divmod(*this, natural(b)).first;
+}
+natural & natural::operator %= (uint64_t b) {
+    uint64_t r = *this % b;
+    digits.clear();
+    return *this += r;
+}
+natural operator + (natural const & a, uint64_t b) {
+    natural c = a;
+    c += b;
+    return c;
+}
+natural operator + (uint64_t a, natural const & b) {
+    return b + a;
+}
+natural operator - (natural const & a, uint64_t b) {
+    natural c = a;
+    c -= b;
+    return c;
+}
+natural operator - (uint64_t a, natural const & b) {
+    natural c = b;
+    c.subtract_from(a);
+    return c;
+}
+natural operator * (natural const & a, uint64_t b) {
     natural c = a;
     c *= b;
     return c;
 }
+natural operator * (uint64_t a, natural const & b) {
+    return b * a;
+}
+natural operator / (natural const & a, uint64_t b) {
+    natural c = a;
+    c /= b;
+    return c;
+}
+uint64_t operator % (natural const & an, uint64_t b) {
+    assert (b != 0);
+    if (natural::high_digit(b) == 0) {
+        natural::digits_t const & a = an.digits;
+        natural::double_digit_t t = 0;
+        for (int i = a.size() - 1; 0 <= i; --i) {
+            t = (natural::to_high_digit(t) + a[i]) % b;
+        }
+        return t;
+    }
+    return natural::divmod(an, natural(b)).second.to_uint64();
+}
 std::pair<natural,natural> natural::split_at(natural const & n, int p) {
     natural a = n;
     natural b = a.drop(p);
@@ -183,45 +324,66 @@ void natural::lshift_digit(int b) {
     }
 }
 
-std::pair<natural,natural> natural::divmod(natural const & _an, natural const & bn) {
+std::pair<natural,natural> natural::divmod(natural const & an, natural const & bn) {
     assert (bn != natural(0));
-    if (_an < bn) return std::make_pair(natural(0), _an);
-    natural::digits_t a = _an.digits; // inplace
+    if (an < bn) return std::make_pair(natural(0), an);
+    natural::digits_t const & a = an.digits;
     natural::digits_t const & b = bn.digits;
-    const int bl = b.size();
-    // natural::digits_t q(a.size() - b.size() + 1);
-    natural q;
-    for (int i = a.size() - b.size(); 0 <= i; --i) {
-        if (natural(a) < bn) break;
-        if (1 <= i) {
-            natural::double_digit_t t = (natural::to_high_digit(a[i+bl-1]) + a[i+bl-2]) / b[bl-1];
-            natural x = natural(natural::digits_t({ natural::low_digit(t), natural::high_digit(t) }));
-            natural y = natural::lshift_digit(natural(1), i-1);
-            x *= y;
-            while (natural(a) < bn * x) {
-                x -= y;
-            }
-            q += x;
-            a = (natural(a) - bn * x).digits;
-        } else {
-            assert (a.back() != 0);
-            assert (a.size() == b.size());
-            assert (1 <= a.size());
-            int l = a.size();
-            natural::digit_t t = l == 1
-                ? a[0] / b[0]
-                : (natural::to_high_digit(a[l-1]) + a[l-2]) / (natural::to_high_digit(b[l-1]) + b[l-2]) ;
-            natural x = natural(t);
-            while (natural(a) < bn * x) {
-                -- x;
+    const int n = b.size();
+    const int m = a.size();
+    natural::digits_t q(m - n + 1);
+    if (n == 1) {
+        natural::double_digit_t t = 0;
+        for (int i = m-1; 0 <= i; --i) {
+            t = natural::to_high_digit(t) + a[i];
+            q[i] = t / b[0];
+            t %= b[0];
+        }
+        return std::make_pair(natural(q), natural(natural::low_digit(t)));
+    }
+    // Knuth's algorithm D, with the divisor normalized to have its highest bit set
+    int s = 0;
+    for (natural::digit_t t = b.back(); not (t & natural::digit_highest_bit); t <<= 1) ++s;
+    natural::digits_t u = (an << s).digits; // inplace
+    u.resize(m + 1);
+    natural const vn = bn << s;
+    natural::digits_t const & v = vn.digits;
+    for (int j = m - n; 0 <= j; --j) {
+        const natural::double_digit_t t = natural::to_high_digit(u[j+n]) + u[j+n-1];
+        natural::double_digit_t qhat = t / v[n-1];
+        natural::double_digit_t rhat = t % v[n-1];
+        while (qhat >= natural::radix or qhat * v[n-2] > natural::to_high_digit(rhat) + u[j+n-2]) {
+            -- qhat;
+            rhat += v[n-1];
+            if (rhat >= natural::radix) break;
+        }
+        // u -= qhat * v
+        natural::digit_t borrow = 0;
+        natural::digit_t overflow = 0;
+        for (int i = 0; i <= n; ++i) {
+            natural::double_digit_t p = qhat * (i < n ? v[i] : 0) + overflow;
+            overflow = natural::high_digit(p);
+            natural::double_digit_t d = (natural::double_digit_t) u[i+j] - natural::low_digit(p) - borrow;
+            u[i+j] = natural::low_digit(d);
+            borrow = natural::high_digit(d) ? 1 : 0;
+        }
+        if (borrow) { // qhat was too large by one
+            -- qhat;
+            natural::digit_t carry = 0;
+            for (int i = 0; i <= n; ++i) {
+                natural::double_digit_t d = (natural::double_digit_t) u[i+j] + (i < n ? v[i] : 0) + carry;
+                u[i+j] = natural::low_digit(d);
+                carry = natural::high_digit(d);
             }
-            q += x;
-            a = (natural(a) - bn * x).digits;
         }
+        q[j] = qhat;
     }
-    assert (_an == q * bn + natural(a));
-    assert (natural(a) < bn);
-    return std::make_pair(q, natural(a));
+    u.resize(n);
+    natural r = natural(u);
+    r >>= s;
+    assert (an == natural(q) * bn + r);
+    assert (r < bn);
+    return std::make_pair(natural(q), r);
 }
 
 natural operator / (natural const & a, natural const & b) {
@@ -230,6 +392,90 @@ natural operator / (natural const & a, natural const & b) {
 natural operator % (natural const & a, natural const & b) {
     return natural::divmod(a,b).second;
 }
+natural gcd(natural const & an, natural const & bn) {
+    natural a = an;
+    natural b = bn;
+    while (b) {
+        natural r = a % b;
+        a.digits.swap(b.digits);
+        b.digits.swap(r.digits);
+    }
+    return a;
+}
+natural sqrt(natural const & n) {
+    if (not n) return natural(0);
+    // Newton's method, from above, starting with the root of the upper half
+    int m = n.bit_length() / 4;
+    natural x = m < natural::digit_digits
+        ? natural(1) << ((n.bit_length() + 1) / 2)
+        : (sqrt(n >> (2 * m)) + natural(1)) << m;
+    while (true) {
+        natural y = (x + n / x) >> 1;
+        if (x <= y) break;
+        x = y;
+    }
+    assert (x * x <= n and n < (x + natural(1)) * (x + natural(1)));
+    return x;
+}
+
+// shift by bits
+natural & natural::operator <<= (int b) {
+    assert (0 <= b);
+    natural::digits_t & a = digits;
+    if (a.empty()) return *this;
+    int r = b % natural::digit_digits;
+    if (r) {
+        natural::digit_t overflow = 0;
+        for (int i = 0; i < a.size(); ++i) {
+            natural::double_digit_t t = ((natural::double_digit_t) a[i] << r) | overflow;
+            a[i] = natural::low_digit(t);
+            overflow = natural::high_digit(t);
+        }
+        if (overflow) a.push_back(overflow);
+    }
+    lshift_digit(b / natural::digit_digits);
+    return *this;
+}
+natural & natural::operator >>= (int b) {
+    assert (0 <= b);
+    natural::digits_t & a = digits;
+    if (a.size() <= b / natural::digit_digits) { a.clear(); return *this; }
+    rshift_digit(b / natural::digit_digits);
+    int r = b % natural::digit_digits;
+    if (r) {
+        for (int i = 0; i < a.size(); ++i) {
+            natural::double_digit_t t = natural::to_high_digit(i+1 < a.size() ? a[i+1] : 0) | a[i];
+            a[i] = natural::low_digit(t >> r);
+        }
+        normalize();
+    }
+    return *this;
+}
+natural operator << (natural const & a, int b) {
+    natural c = a;
+    c <<= b;
+    return c;
+}
+natural operator >> (natural const & a, int b) {
+    natural c = a;
+    c >>= b;
+    return c;
+}
+int natural::bit_length() const {
+    if (digits.empty()) return 0;
+    int l = digits.size() * natural::digit_digits;
+    for (natural::digit_t t = digits.back(); not (t & natural::digit_highest_bit); t <<= 1) --l;
+    return l;
+}
+int natural::count_trailing_zeros() const {
+    int l = 0;
+    for (int i = 0; i < digits.size(); ++i) {
+        if (digits[i] == 0) { l += natural::digit_digits; continue; }
+        for (natural::digit_t t = digits[i]; not (t & 1); t >>= 1) ++l;
+        return l;
+    }
+    return 0;
+}
 
 bool operator == (natural const & a, natural const & b) {
     assert (a.valid());
@@ -270,14 +516,56 @@ bool operator >  (natural const & a, natural const & b) {
     return not (a <= b);
 }
 
+bool operator == (natural const & a, uint64_t b) {
+    return a.fits_uint64() and a.to_uint64() == b;
+}
+bool operator != (natural const & a, uint64_t b) {
+    return not (a == b);
+}
+bool operator <= (natural const & a, uint64_t b) {
+    return a.fits_uint64() and a.to_uint64() <= b;
+}
+bool operator <  (natural const & a, uint64_t b) {
+    return a.fits_uint64() and a.to_uint64() < b;
+}
+bool operator >= (natural const & a, uint64_t b) {
+    return not (a < b);
+}
+bool operator >  (natural const & a, uint64_t b) {
+    return not (a <= b);
+}
+bool operator == (uint64_t a, natural const & b) {
+    return b == a;
+}
+bool operator != (uint64_t a, natural const & b) {
+    return b != a;
+}
+bool operator <= (uint64_t a, natural const & b) {
+    return b >= a;
+}
+bool operator <  (uint64_t a, natural const & b) {
+    return b >  a;
+}
+bool operator >= (uint64_t a, natural const & b) {
+    return b <= a;
+}
+bool operator >  (uint64_t a, natural const & b) {
+    return b <  a;
+}
+
 natural::operator bool () const {
     return not digits.empty();
 }
+bool natural::fits_int() const {
+    return *this <= (uint64_t) std::numeric_limits<long long int>::max();
+}
 long long int natural::to_int() const {
-    natural::double_digit_t t = 0;
-    if (1 < digits.size()) t += natural::to_high_digit(digits[1]);
-    if (0 < digits.size()) t += digits[0];
-    return t;
+#ifdef NDEBUG
+    if (not fits_int()) return std::numeric_limits<long long int>::max();
+#else
+    assert (fits_int());
+#endif
+    return to_uint64();
 }
 
 std::experimental::optional<natural> natural::from_string(std::string const & s) {
@@ -285,18 +573,21 @@ std::experimental::optional<natural> natural::from_string(std::string const & s)
     for (int i = 0; i < s.length(); ++i) {
         if (not isdigit(s[i])) return std::experimental::optional<natural>();
         a *= 10;
-        a += natural(s[i]-'0');
+        a += s[i]-'0';
     }
     return std::experimental::optional<natural>(a);
 }
 std::string natural::to_string() const {
+    // nine decimal digits at once
+    const natural::digit_t base = 1000000000;
     std::string s;
     natural a = *this;
-    while (a != natural(0)) {
-        auto p = natural::divmod(a, natural(10));
-        assert (0 <= p.second.to_int() and p.second.to_int() <= 9);
-        s += p.second.to_int() + '0';
-        a  = p.first;
+    while (a) {
+        natural::digit_t r = a.divide_digit(base);
+        for (int i = 0; i < 9 and (a or r); ++i) {
+            s += r % 10 + '0';
+            r /= 10;
+        }
     }
     if (s.empty()) s += '0';
     reverse(s.begin(), s.end());
@@ -16,16 +16,19 @@ public:
     typedef uint64_t double_digit_t;
     static const digit_t digit_max = std::numeric_limits<digit_t>::max();
     static const int  digit_digits = std::numeric_limits<digit_t>::digits;
-    static const digit_t digit_highest_bit = 1 << (digit_digits-1);
+    static const digit_t digit_highest_bit = (digit_t) 1 << (digit_digits-1);
     static const double_digit_t radix = (double_digit_t) digit_max + 1;
-    static digit_t high_digit(double_digit_t a) { return a >> digit_digits; }
-    static digit_t  low_digit(double_digit_t a) { return a; }
-    static double_digit_t to_high_digit(digit_t a) { return (double_digit_t) a << digit_digits; }
+    static constexpr digit_t high_digit(double_digit_t a) { return a >> digit_digits; }
+    static constexpr digit_t  low_digit(double_digit_t a) { return a; }
+    static constexpr double_digit_t to_high_digit(digit_t a) { return (double_digit_t) a << digit_digits; }
     typedef std::vector<digit_t> digits_t;
 
 public:
     natural() : digits(0) {}
-    explicit natural(digit_t n) { if (n != 0) digits.push_back(n); }
+    explicit natural(uint64_t n) {
+        if (n != 0) digits.push_back(low_digit(n));
+        if (high_digit(n) != 0) digits.push_back(high_digit(n));
+    }
     explicit natural(std::string const & s) {
         auto t = natural::from_string(s);
         *this = t ? *t : natural(0);
@@ -47,28 +50,68 @@ public:
     natural   operator -- (int);
     natural & operator += (natural const & n);
     natural & operator -= (natural const & n);
+    natural & subtract_from(natural const & n); // *this = n - *this, inplace
     natural & operator *= (natural const & n);
+    natural & operator += (uint64_t n);
+    natural & operator -= (uint64_t n);
+    natural & subtract_from(uint64_t n); // *this = n - *this, inplace
+    natural & operator *= (uint64_t n);
+    natural & operator /= (uint64_t n);
+    natural & operator %= (uint64_t n);
     friend natural operator + (natural const & a, natural const & b);
     friend natural operator - (natural const & a, natural const & b);
     friend natural operator * (natural const & a, natural const & b);
     static std::pair<natural,natural> divmod(natural const & a, natural const & b);
     friend natural operator / (natural const & a, natural const & b);
     friend natural operator % (natural const & a, natural const & b);
+    friend natural operator + (natural const & a, uint64_t b);
+    friend natural operator + (uint64_t a, natural const & b);
+    friend natural operator - (natural const & a, uint64_t b);
+    friend natural operator - (uint64_t a, natural const & b);
+    friend natural operator * (natural const & a, uint64_t b);
+    friend natural operator * (uint64_t a, natural const & b);
+    friend natural operator / (natural const & a, uint64_t b);
+    friend uint64_t operator % (natural const & a, uint64_t b);
+    friend natural gcd(natural const & a, natural const & b);
+    friend natural sqrt(natural const & n); // floor
+    natural & operator <<= (int n);
+    natural & operator >>= (int n);
+    friend natural operator << (natural const & a, int b);
+    friend natural operator >> (natural const & a, int b);
+    int bit_length() const; // the position of the highest bit, 1-origin
+    int count_trailing_zeros() const; // 0 for 0
     friend bool operator == (natural const & a, natural const & b);
     friend bool operator != (natural const & a, natural const & b);
     friend bool operator <= (natural const & a, natural const & b);
     friend bool operator <  (natural const & a, natural const & b);
     friend bool operator >= (natural const & a, natural const & b);
     friend bool operator >  (natural const & a, natural const & b);
+    friend bool operator == (natural const & a, uint64_t b);
+    friend bool operator != (natural const & a, uint64_t b);
+    friend bool operator <= (natural const & a, uint64_t b);
+    friend bool operator <  (natural const & a, uint64_t b);
+    friend bool operator >= (natural const & a, uint64_t b);
+    friend bool operator >  (natural const & a, uint64_t b);
+    friend bool operator == (uint64_t a, natural const & b);
+    friend bool operator != (uint64_t a, natural const & b);
+    friend bool operator <= (uint64_t a, natural const & b);
+    friend bool operator <  (uint64_t a, natural const & b);
+    friend bool operator >= (uint64_t a, natural const & b);
+    friend bool operator >  (uint64_t a, natural const & b);
     explicit operator bool () const;
-    long long int to_int() const;
+    bool fits_int() const;
+    long long int to_int() const; // requires fits_int()
     static std::experimental::optional<natural> from_string(std::string const & s);
     std::string to_string() const;
     friend std::istream & operator >> (std::istream & input, natural & n);
     friend std::ostream & operator << (std::ostream & output, natural const & n);
 private:
-    natural & operator *= (digit_t n); // for implementation
-    friend natural operator * (natural const & a, digit_t b);
+    digit_t divide_digit(digit_t b); // divide inplace and return the remainder
+    bool fits_uint64() const { return digits.size() <= 2; }
+    uint64_t to_uint64() const {
+        assert (fits_uint64());
+        return (digits.size() < 2 ? 0 : to_high_digit(digits[1])) + (digits.size() < 1 ? 0 : digits[0]);
+    }
     bool valid() const {
         return digits.empty() or digits.back() != 0;
     }
@@ -83,5 +126,7 @@ private:
     static std::pair<natural,natural> split_at(natural const & n, int p); // { upper, lower }
     natural drop(int n); // drop lower n digits and update the remaining upper digits
 private:
+    template <int Bits> friend class fixed_natural;
     digits_t digits;
 };
+natural sqrt(natural const & n);
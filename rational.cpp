@@ -0,0 +1,135 @@
+#include "rational.hpp"
+
+static integer exact_div(integer const & a, natural const & b) {
+    assert (not (a % integer(b)));
+    return a / integer(b);
+}
+
+rational::rational(integer const & num_, integer const & den_) {
+    assert (den_);
+    natural g = gcd(abs(num_).to_natural(), abs(den_).to_natural());
+    num = integer((num_ < integer()) != (den_ < integer()), abs(num_).to_natural() / g);
+    den = abs(den_).to_natural() / g;
+    assert (valid());
+}
+
+// Henrici's algorithms: take gcds of the smaller operands, instead of the gcd of the products
+rational & rational::operator += (rational const & n) {
+    if (not n.num) return *this;
+    if (not num) return *this = n;
+    natural g = gcd(den, n.den);
+    if (g == natural(1)) {
+        num = num * integer(n.den) + n.num * integer(den);
+        den *= n.den;
+    } else {
+        natural s = den / g;
+        integer t = num * integer(n.den / g) + n.num * integer(s);
+        if (not t) return *this = rational();
+        natural g2 = gcd(abs(t).to_natural(), g);
+        num = exact_div(t, g2);
+        den = s * (n.den / g2);
+    }
+    assert (valid());
+    return *this;
+}
+rational & rational::operator -= (rational const & n) {
+    return *this += - n;
+}
+rational & rational::operator *= (rational const & n) {
+    if (not num or not n.num) return *this = rational();
+    natural g1 = gcd(abs(num).to_natural(), n.den);
+    natural g2 = gcd(abs(n.num).to_natural(), den);
+    num = exact_div(num, g1) * exact_div(n.num, g2);
+    den = (den / g2) * (n.den / g1);
+    assert (valid());
+    return *this;
+}
+rational & rational::operator /= (rational const & n) {
+    assert (n.num);
+    return *this *= rational(n.num < integer() ? - integer(n.den) : integer(n.den), abs(n.num).to_natural(), reduced_tag());
+}
+rational operator + (rational const & a, rational const & b) {
+    rational c = a;
+    c += b;
+    return c;
+}
+rational operator - (rational const & a) {
+    return rational(- a.num, a.den, rational::reduced_tag());
+}
+rational operator - (rational const & a, rational const & b) {
+    rational c = a;
+    c -= b;
+    return c;
+}
+rational operator * (rational const & a, rational const & b) {
+    rational c = a;
+    c *= b;
+    return c;
+}
+rational operator / (rational const & a, rational const & b) {
+    rational c = a;
+    c /= b;
+    return c;
+}
+bool operator == (rational const & a, rational const & b) {
+    return a.num == b.num and a.den == b.den;
+}
+bool operator != (rational const & a, rational const & b) {
+    return not (a == b);
+}
+bool operator <= (rational const & a, rational const & b) {
+    return a.num * integer(b.den) <= b.num * integer(a.den);
+}
+bool operator <  (rational const & a, rational const & b) {
+    return a != b and a <= b;
+}
+bool operator >= (rational const & a, rational const & b) {
+    return not (a < b);
+}
+bool operator >  (rational const & a, rational const & b) {
+    return not (a <= b);
+}
+rational::operator bool () const {
+    return bool(num);
+}
+rational abs(rational const & n) {
+    return rational(abs(n.num), n.den, rational::reduced_tag());
+}
+integer rational::numerator() const {
+    return num;
+}
+natural rational::denominator() const {
+    return den;
+}
+integer rational::trunc() const {
+    return num / integer(den);
+}
+std::string rational::to_string() const {
+    if (den == natural(1)) return num.to_string();
+    return num.to_string() + "/" + den.to_string();
+}
+std::experimental::optional<rational> rational::from_string(std::string const & s) {
+    using namespace std::experimental;
+    size_t i = s.find('/');
+    if (i == std::string::npos) {
+        optional<integer> n = integer::from_string(s);
+        return n ? optional<rational>(rational(*n)) : optional<rational>();
+    }
+    optional<integer> n = integer::from_string(s.substr(0, i));
+    optional<natural> d = natural::from_string(s.substr(i+1));
+    if (not n or not d or not *d) return optional<rational>();
+    return optional<rational>(rational(*n, integer(*d)));
+}
+std::istream & operator >> (std::istream & input, rational & n) {
+    std::string s;
+    input >> s;
+    if (not input.fail()) {
+        auto t = rational::from_string(s);
+        n = t ? *t : rational();
+        if (not t) input.setstate(std::ios::failbit);
+    }
+    return input;
+}
+std::ostream & operator << (std::ostream & output, rational const & n) {
+    return output << n.to_string();
+}
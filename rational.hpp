@@ -0,0 +1,56 @@
+#pragma once
+#include "integer.hpp"
+
+// thanks to:
+// - Knuth, TAOCP vol.2, 4.5.1 (Henrici's algorithms)
+
+class rational {
+public:
+    rational() : num(), den(1) {}
+    /* implicit */ rational(integer const & n_) : num(n_), den(1) {}
+    /* implicit */ rational(natural const & n_) : num(n_), den(1) {}
+    rational(integer const & num_, integer const & den_);
+    explicit rational(int64_t n_) : num(n_), den(1) {}
+#ifdef NDEBUG
+    ~rational() = default; // non virtual
+#else
+    ~rational() { assert (valid()); }
+#endif
+private:
+    struct reduced_tag {};
+    rational(integer const & num_, natural const & den_, reduced_tag) : num(num_), den(den_) {
+        assert (gcd(abs(num).to_natural(), den) == natural(1));
+    }
+public:
+    rational & operator += (rational const & n);
+    rational & operator -= (rational const & n);
+    rational & operator *= (rational const & n);
+    rational & operator /= (rational const & n);
+    friend rational operator + (rational const & a, rational const & b);
+    friend rational operator - (rational const & a);
+    friend rational operator - (rational const & a, rational const & b);
+    friend rational operator * (rational const & a, rational const & b);
+    friend rational operator / (rational const & a, rational const & b);
+    friend bool operator == (rational const & a, rational const & b);
+    friend bool operator != (rational const & a, rational const & b);
+    friend bool operator <= (rational const & a, rational const & b);
+    friend bool operator <  (rational const & a, rational const & b);
+    friend bool operator >= (rational const & a, rational const & b);
+    friend bool operator >  (rational const & a, rational const & b);
+    explicit operator bool () const;
+    friend rational abs(rational const & n);
+    integer numerator() const;
+    natural denominator() const;
+    integer trunc() const;
+    std::string to_string() const;
+    static std::experimental::optional<rational> from_string(std::string const & s);
+    friend std::istream & operator >> (std::istream & input, rational & n);
+    friend std::ostream & operator << (std::ostream & output, rational const & n);
+private:
+    bool valid() const {
+        return den != natural(0) and (num or den == natural(1));
+    }
+private:
+    integer num; // the sign is here
+    natural den; // positive, coprime to num
+};
@@ -0,0 +1,172 @@
+#include "rns_natural.hpp"
+
+typedef rns_basis::residue_t residue_t;
+
+static residue_t mod_pow(residue_t x, residue_t k, residue_t p) {
+    uint64_t y = 1;
+    uint64_t z = x;
+    for (; k; k >>= 1) {
+        if (k & 1) y = y * z % p;
+        z = z * z % p;
+    }
+    return y;
+}
+static bool is_prime(residue_t n) { // Miller-Rabin, deterministic for n < 2^32
+    if (n < 2) return false;
+    for (residue_t p : { 2, 3, 5, 7, 61 }) {
+        if (n % p == 0) return n == p;
+    }
+    residue_t d = n - 1;
+    int s = 0;
+    for (; d % 2 == 0; d /= 2) ++ s;
+    for (residue_t a : { 2, 7, 61 }) {
+        uint64_t x = mod_pow(a, d, n);
+        if (x == 1 or x == n - 1) continue;
+        bool composite = true;
+        for (int i = 1; i < s and composite; ++i) {
+            x = x * x % n;
+            if (x == n - 1) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+rns_basis::rns_basis(int bits) {
+    natural m = natural(1);
+    for (residue_t p = (1u << 30) - 1; primes.empty() or m.bit_length() <= bits; p -= 2) {
+        assert (p > (1u << 29)); // the basis for bits up to about 7 * 10^8 is in range
+        if (not is_prime(p)) continue;
+        primes.push_back(p);
+        m *= p;
+    }
+    // the subproduct tree
+    tree.emplace_back();
+    for (residue_t p : primes) tree.back().push_back(natural(p));
+    while (tree.back().size() != 1) {
+        std::vector<natural> const & a = tree.back();
+        std::vector<natural> b;
+        for (int i = 0; i + 1 < a.size(); i += 2) b.push_back(a[i] * a[i+1]);
+        if (a.size() % 2 == 1) b.push_back(a.back());
+        tree.push_back(b);
+    }
+    assert (tree.back().back() == m);
+    // (M/p_i)^{-1} mod p_i
+    for (int i = 0; i < primes.size(); ++i) {
+        uint64_t t = 1;
+        for (int j = 0; j < primes.size(); ++j) {
+            if (j != i) t = t * (primes[j] % primes[i]) % primes[i];
+        }
+        inverses.push_back(mod_pow(t, primes[i] - 2, primes[i]));
+        barrett.push_back(((uint64_t) 1 << 60) / primes[i]);
+    }
+}
+int rns_basis::size() const {
+    return primes.size();
+}
+residue_t rns_basis::prime(int i) const {
+    return primes[i];
+}
+natural const & rns_basis::modulus() const {
+    return tree.back().back();
+}
+std::vector<residue_t> rns_basis::residues(natural const & n) const {
+    std::vector<residue_t> r(primes.size());
+    for (int i = 0; i < primes.size(); ++i) r[i] = n % primes[i];
+    return r;
+}
+natural rns_basis::reconstruct(std::vector<residue_t> const & r) const {
+    assert (r.size() == primes.size());
+    // \sum_i c_i M/p_i with c_i = r_i (M/p_i)^{-1} mod p_i, summed up along the subproduct tree
+    std::vector<natural> x(primes.size());
+    for (int i = 0; i < primes.size(); ++i) {
+        x[i] = natural((uint64_t) r[i] * inverses[i] % primes[i]);
+    }
+    for (int l = 0; l + 1 < tree.size(); ++l) {
+        std::vector<natural> const & a = tree[l];
+        std::vector<natural> y;
+        for (int i = 0; i + 1 < a.size(); i += 2) y.push_back(x[i] * a[i+1] + x[i+1] * a[i]);
+        if (a.size() % 2 == 1) y.push_back(x.back());
+        x.swap(y);
+    }
+    return x.front() % modulus();
+}
+
+rns_natural::rns_natural(std::shared_ptr<rns_basis const> const & basis_)
+    : basis(basis_), residues(basis_->size()) {}
+rns_natural::rns_natural(std::shared_ptr<rns_basis const> const & basis_, natural const & n)
+    : basis(basis_), residues(basis_->residues(n)) {}
+natural rns_natural::to_natural() const {
+    return basis->reconstruct(residues);
+}
+
+// the loops below have no dependency across the residues, so that they are vectorized
+// a and b may be the same vector as in x += x, which is fine for elementwise loops but forbids __restrict on them
+rns_natural & rns_natural::operator += (rns_natural const & n) {
+    assert (basis == n.basis);
+    const int k = residues.size();
+    residue_t * a = residues.data();
+    residue_t const * b = n.residues.data();
+    residue_t const * __restrict p = basis->primes.data();
+#pragma GCC ivdep
+    for (int i = 0; i < k; ++i) {
+        residue_t t = a[i] + b[i]; // < 2^31
+        a[i] = t >= p[i] ? t - p[i] : t;
+    }
+    return *this;
+}
+rns_natural & rns_natural::operator -= (rns_natural const & n) {
+    assert (basis == n.basis);
+    const int k = residues.size();
+    residue_t * a = residues.data();
+    residue_t const * b = n.residues.data();
+    residue_t const * __restrict p = basis->primes.data();
+#pragma GCC ivdep
+    for (int i = 0; i < k; ++i) {
+        residue_t t = a[i] + p[i] - b[i]; // < 2^31
+        a[i] = t >= p[i] ? t - p[i] : t;
+    }
+    return *this;
+}
+rns_natural & rns_natural::operator *= (rns_natural const & n) {
+    assert (basis == n.basis);
+    const int k = residues.size();
+    residue_t * a = residues.data();
+    residue_t const * b = n.residues.data();
+    residue_t const * __restrict p = basis->primes.data();
+    residue_t const * __restrict m = basis->barrett.data();
+#pragma GCC ivdep
+    for (int i = 0; i < k; ++i) {
+        // Barrett reduction of x < 2^60, with only 32x32 -> 64 bit products
+        uint64_t x = (uint64_t) a[i] * b[i];
+        // the truncations of m, of x >> 28 and of the last shift lose less than 1, 1/2 and 1 respectively
+        residue_t q = ((uint64_t) (residue_t) (x >> 28) * m[i]) >> 32; // floor(x/p) - 2 <= q <= floor(x/p)
+        residue_t r = (residue_t) x - q * p[i]; // < 3p < 2^32
+        r = r >= p[i] ? r - p[i] : r;
+        r = r >= p[i] ? r - p[i] : r;
+        a[i] = r;
+    }
+    return *this;
+}
+rns_natural operator + (rns_natural const & a, rns_natural const & b) {
+    rns_natural c = a;
+    c += b;
+    return c;
+}
+rns_natural operator - (rns_natural const & a, rns_natural const & b) {
+    rns_natural c = a;
+    c -= b;
+    return c;
+}
+rns_natural operator * (rns_natural const & a, rns_natural const & b) {
+    rns_natural c = a;
+    c *= b;
+    return c;
+}
+bool operator == (rns_natural const & a, rns_natural const & b) {
+    assert (a.basis == b.basis);
+    return a.residues == b.residues;
+}
+bool operator != (rns_natural const & a, rns_natural const & b) {
+    return not (a == b);
+}
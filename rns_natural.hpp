@@ -0,0 +1,46 @@
+#pragma once
+#include "natural.hpp"
+#include <memory>
+
+// thanks to:
+// - von zur Gathen, Gerhard, "Modern Computer Algebra", 10.3 (fast Chinese remaindering)
+
+// a set of word-size primes p_0, ..., p_{k-1} with M = p_0 ... p_{k-1}, and the subproduct tree over them
+// the primes are in (2^29, 2^30), so that the sum of two residues and the Barrett reduction fit in a residue_t
+class rns_basis {
+public:
+    typedef uint32_t residue_t;
+    explicit rns_basis(int bits); // the smallest set of the largest primes with 2^bits <= M
+    int size() const;
+    residue_t prime(int i) const;
+    natural const & modulus() const;
+    std::vector<residue_t> residues(natural const & n) const;
+    natural reconstruct(std::vector<residue_t> const & r) const; // the x < M with x = r_i mod p_i
+private:
+    friend class rns_natural;
+    std::vector<residue_t> primes;
+    std::vector<residue_t> inverses; // (M/p_i)^{-1} mod p_i
+    std::vector<residue_t> barrett; // floor(2^60 / p_i)
+    std::vector<std::vector<natural> > tree; // tree[0] are the primes, tree.back() is { M }
+};
+
+// a natural number modulo M, as its residues; + - * work on each residue independently
+class rns_natural {
+public:
+    typedef rns_basis::residue_t residue_t;
+    explicit rns_natural(std::shared_ptr<rns_basis const> const & basis_);
+    rns_natural(std::shared_ptr<rns_basis const> const & basis_, natural const & n);
+    natural to_natural() const;
+public:
+    rns_natural & operator += (rns_natural const & n);
+    rns_natural & operator -= (rns_natural const & n); // modulo M
+    rns_natural & operator *= (rns_natural const & n);
+    friend rns_natural operator + (rns_natural const & a, rns_natural const & b);
+    friend rns_natural operator - (rns_natural const & a, rns_natural const & b);
+    friend rns_natural operator * (rns_natural const & a, rns_natural const & b);
+    friend bool operator == (rns_natural const & a, rns_natural const & b);
+    friend bool operator != (rns_natural const & a, rns_natural const & b);
+private:
+    std::shared_ptr<rns_basis const> basis;
+    std::vector<residue_t> residues;
+};
@@ -0,0 +1,115 @@
+#include "series.hpp"
+#include <future>
+#include <cmath>
+#include <algorithm>
+
+series::series(coefficient_t a_, coefficient_t p_, coefficient_t q_) : a(a_), p(p_), q(q_) {}
+series::series(coefficient_t a_, coefficient_t p_, coefficient_t q_, coefficient_t b_) : a(a_), p(p_), q(q_), b(b_) {}
+
+series::partial series::split(int n1, int n2, int parallel_depth) const {
+    assert (n1 < n2);
+    if (n2 - n1 == 1) {
+        partial x;
+        x.p = p(n1);
+        x.q = q(n1);
+        x.b = b ? b(n1) : integer(1);
+        x.t = a(n1) * x.p;
+        return x;
+    }
+    int m = (n1 + n2) / 2;
+    partial l, r;
+    if (0 < parallel_depth) {
+        auto f = std::async(std::launch::async, [&]() { return split(n1, m, parallel_depth - 1); });
+        r = split(m, n2, parallel_depth - 1);
+        l = f.get();
+    } else {
+        l = split(n1, m);
+        r = split(m, n2);
+    }
+    partial x;
+    if (b) {
+        x.t = r.b * r.q * l.t + l.b * l.p * r.t;
+        x.b = l.b * r.b;
+    } else {
+        x.t = r.q * l.t + l.p * r.t;
+        x.b = integer(1);
+    }
+    x.p = l.p * r.p;
+    x.q = l.q * r.q;
+    return x;
+}
+
+rational series::sum(int n, int parallel_depth) const {
+    if (n <= 0) return rational();
+    partial x = split(0, n, parallel_depth);
+    return rational(x.t, x.b * x.q);
+}
+bigfloat series::evaluate(int n, int prec, int parallel_depth) const {
+    if (n <= 0) return bigfloat::zero(prec);
+    partial x = split(0, n, parallel_depth);
+    return bigfloat::div(bigfloat::exact(x.t), bigfloat::exact(x.b * x.q), prec); // without reducing T/BQ
+}
+
+bigfloat series::pi(int prec, int parallel_depth) {
+    // 1/pi = 12/640320^{3/2} \sum_k (-1)^k (6k)! (13591409 + 545140134k) / (3k)! (k!)^3 640320^{3k}
+    // each term gives log2(640320^3/1728) ~ 47.11 bits
+    const integer c = integer(natural("10939058860032000")); // 640320^3 / 24
+    series s(
+        [](int k) { return integer(13591409) + integer(545140134) * integer(k); },
+        [](int k) { return k == 0 ? integer(1) : - integer(6*k-5) * integer(2*k-1) * integer(6*k-1); },
+        [c](int k) { return k == 0 ? integer(1) : integer(k) * integer(k) * integer(k) * c; });
+    int n = prec / 47 + 2;
+    int guard = prec + 32;
+    partial x = s.split(0, n, parallel_depth);
+    // pi = 426880 sqrt(10005) Q / T
+    bigfloat y = bigfloat::sqrt(bigfloat(integer(10005), guard), guard);
+    y = bigfloat::mul(y, bigfloat::exact(integer(426880) * x.q), guard);
+    y = bigfloat::div(y, bigfloat::exact(x.t), guard);
+    return bigfloat::round(y, prec);
+}
+bigfloat series::e(int prec, int parallel_depth) {
+    // e = \sum_k 1/k!, and log2 n! > prec suffices
+    int n = 1;
+    for (double bits = 0; bits < prec + 2; ++ n) bits += std::log2(n);
+    series s(
+        [](int) { return integer(1); },
+        [](int) { return integer(1); },
+        [](int k) { return k == 0 ? integer(1) : integer(k); });
+    return s.evaluate(n, prec, parallel_depth);
+}
+// 2 atanh(u/v) = log((v+u)/(v-u)), for |u/v| <= 1/3
+static bigfloat log_near_one(integer const & u, integer const & v, int prec, int parallel_depth) {
+    // 2 atanh z = 2 \sum_k z^{2k+1}/(2k+1)
+    assert (abs(u) * 3 <= v);
+    if (not u) return bigfloat::zero(prec);
+    // |z|^{2n} <= 9^{-n} < 2^{-prec}
+    int n = prec / 3 + 2;
+    series s(
+        [](int) { return integer(2); },
+        [u](int k) { return k == 0 ? u : u * u; },
+        [v](int k) { return k == 0 ? v : v * v; },
+        [](int k) { return integer(2*k+1); });
+    return s.evaluate(n, prec, parallel_depth);
+}
+bigfloat series::log(rational const & x, int prec, int parallel_depth) {
+    // log x = k log 2 + log y, where y = x/2^k is in [1/sqrt 2, sqrt 2]
+    assert (rational() < x);
+    natural a = abs(x.numerator()).to_natural();
+    natural b = x.denominator();
+    int k = a.bit_length() - b.bit_length();
+    if (0 <= k) b <<= k; else a <<= - k; // a/b is in (1/2, 2)
+    if (b * b * 2 < a * a) {
+        b <<= 1;
+        ++ k;
+    } else if (a * a * 2 < b * b) {
+        a <<= 1;
+        -- k;
+    }
+    int guard = prec + 32;
+    // the z of y is at most (sqrt 2 - 1)/(sqrt 2 + 1) < 1/3 in magnitude
+    bigfloat y = log_near_one(integer(a) - integer(b), integer(a + b), guard, parallel_depth);
+    if (k == 0) return bigfloat::round(y, prec);
+    bigfloat log2 = log_near_one(integer(1), integer(3), guard, parallel_depth);
+    y = bigfloat::add(bigfloat::mul(bigfloat(integer(k), guard), log2, guard), y, guard);
+    return bigfloat::round(y, prec);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "integer.hpp"
+#include "rational.hpp"
+#include "bigfloat.hpp"
+#include <functional>
+
+// thanks to:
+// - Haible, Papanikolaou, "Fast multiprecision evaluation of series of rational numbers", 1997
+
+// a series \sum_{n} a(n)/b(n) * p(0)...p(n) / q(0)...q(n) of rational terms, evaluated by binary splitting
+class series {
+public:
+    typedef std::function<integer (int)> coefficient_t;
+    struct partial { // P = p(n1)...p(n2-1), Q = q(n1)...q(n2-1), B = b(n1)...b(n2-1), and T such that the sum over [n1,n2) is T/BQ
+        integer p, q, b, t;
+    };
+public:
+    series(coefficient_t a_, coefficient_t p_, coefficient_t q_);
+    series(coefficient_t a_, coefficient_t p_, coefficient_t q_, coefficient_t b_);
+public:
+    partial split(int n1, int n2, int parallel_depth = 0) const; // subtrees above the depth run on their own threads
+    rational sum(int n, int parallel_depth = 0) const; // the first n terms, exactly
+    bigfloat evaluate(int n, int prec, int parallel_depth = 0) const; // the first n terms, with one division at the end
+    // the constants below are accurate to about the last bit
+    static bigfloat pi(int prec, int parallel_depth = 0); // Chudnovsky
+    static bigfloat e(int prec, int parallel_depth = 0);
+    static bigfloat log(rational const & x, int prec, int parallel_depth = 0); // for 0 < x
+private:
+    coefficient_t a, p, q, b; // b is empty for b(n) = 1
+};
@@ -12,6 +12,8 @@ int main() {
         cout << a * b << endl;
     } else if (c == '/') {
         cout << a / b << endl;
+    } else if (c == '%') {
+        cout << a % b << endl;
     }
     return 0;
 }
@@ -4,7 +4,7 @@ using namespace std;
 natural fact(int x) {
     natural y = natural(1);
     for (int i = 1; i <= x; ++i) {
-        y = y * natural(i);
+        y *= i;
     }
     return y;
 }
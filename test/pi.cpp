@@ -0,0 +1,9 @@
+#include "series.hpp"
+using namespace std;
+
+int main() {
+    int n;
+    cin >> n;
+    cout << series::pi(n * 3.33 + 16, 2).to_string(n) << endl;
+    return 0;
+}
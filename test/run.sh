@@ -3,10 +3,10 @@
 cd test
 
 compile () {
-    g++ -std=c++14 -I.. -g -DDEBUG -o $1 $1.cpp ../natural.cpp ../integer.cpp
+    g++ -std=c++14 -pthread -I.. -g -DDEBUG -o $1 $1.cpp ../natural.cpp ../integer.cpp ../rational.cpp ../bigfloat.cpp ../series.cpp ../rns_natural.cpp
 }
 compile-fast () {
-    g++ -std=c++14 -I.. -O2 -DNDEBUG -o $1 $1.cpp ../natural.cpp ../integer.cpp
+    g++ -std=c++14 -pthread -I.. -O2 -ftree-vectorize -DNDEBUG -o $1 $1.cpp ../natural.cpp ../integer.cpp ../rational.cpp ../bigfloat.cpp ../series.cpp ../rns_natural.cpp
 }
 
 compile unit
@@ -34,6 +34,12 @@ echo this liblrary
 time ( echo 1000 | ./fact > /dev/null )
 echo done
 
+compile-fast pi
+
+echo pi...
+time ( echo 10000 | ./pi > /dev/null )
+echo done
+
 compile calc
 
 check () {
@@ -86,6 +92,7 @@ for i in $(seq 100) ; do
     check $a - $b
     check $a \* $b
     check $a / $b
+    check $a % $b
 done
 
 for i in $(seq 100) ; do
@@ -95,4 +102,5 @@ for i in $(seq 100) ; do
     check $a - $b
     check $a \* $b
     if [ $b -ne 0 ] ; then check $a / $b ; fi
+    if [ $b -ne 0 ] ; then check $a % $b ; fi
 done
@@ -1,10 +1,18 @@
+#include <sstream>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <type_traits>
 #define private public
 #include "natural.hpp"
 #include "natural.hpp"
 #include "natural.hpp"
 #include "natural.hpp"
-#include <sstream>
-#include <random>
+#include "fixed_integer.hpp"
+#include "rational.hpp"
+#include "bigfloat.hpp"
+#include "series.hpp"
+#include "rns_natural.hpp"
 using namespace std;
 
 void test_ordering() {
@@ -125,6 +133,255 @@ void test_shift() {
     assert (e512 == natural::lshift_digit(e384, 16-12));
 }
 
+void test_fixed() {
+    typedef fixed_natural<128> u128;
+    typedef fixed_integer<128> i128;
+    constexpr u128 e64 = u128(0xffffffffffffffffull) + u128(1); // 2^64
+    static_assert (e64 * e64 == u128(), "wraps around modulo 2^128");
+    static_assert ((e64 * u128(7) + u128(5)) / u128(7) == e64, "");
+    static_assert ((e64 * u128(7) + u128(5)) % e64 == u128(5), "");
+    static_assert (i128(-7) / i128(2) == i128(-3), "");
+    static_assert (i128(-7) % i128(2) == i128(-1), "");
+    default_random_engine engine;
+    uniform_int_distribution<natural::digit_t> digit_dist;
+    uniform_int_distribution<int> length_dist(1, 4);
+    for (int i = 0; i < 100; ++i) {
+        natural::digits_t v(length_dist(engine)); for (auto & d : v) d = digit_dist(engine);
+        natural::digits_t w(length_dist(engine)); for (auto & d : w) d = digit_dist(engine);
+        natural a = natural(v);
+        natural b = natural(w);
+        if (not b) continue;
+        fixed_natural<256> af(a), bf(b);
+        assert (af.to_natural() == a);
+        assert ((af + bf).to_natural() == a + b);
+        assert ((af * bf).to_natural() == a * b);
+        assert ((a <= b) == (af <= bf));
+        if (a >= b) assert ((af - bf).to_natural() == a - b);
+        assert ((af / bf).to_natural() == a / b);
+        assert ((af % bf).to_natural() == a % b);
+    }
+    i128 z;
+    assert ((-- z).to_integer() == - integer(1));
+    assert ((++ z).to_integer() == integer() and z == i128() and not z);
+    assert ((z ++).to_integer() == integer() and z == i128(1));
+    uniform_int_distribution<int> short_length_dist(0, 2); // the products fit in 128 bits
+    bernoulli_distribution sign_dist;
+    for (int i = 0; i < 100; ++i) {
+        natural::digits_t v(short_length_dist(engine)); for (auto & d : v) d = digit_dist(engine);
+        natural::digits_t w(short_length_dist(engine)); for (auto & d : w) d = digit_dist(engine);
+        integer a = integer(sign_dist(engine), natural(v));
+        integer b = integer(sign_dist(engine), natural(w));
+        i128 af(a), bf(b);
+        assert (af.to_integer() == a);
+        assert ((af + bf).to_integer() == a + b);
+        assert ((af - bf).to_integer() == a - b);
+        assert ((af * bf).to_integer() == a * b);
+        assert ((a <= b) == (af <= bf));
+        assert ((a <  b) == (af <  bf));
+        assert ((a == b) == (af == bf));
+        i128 cf = af; cf += bf; cf -= af;
+        assert (cf == bf);
+        if (not b) continue;
+        assert ((af / bf).to_integer() == a / b);
+        assert ((af % bf).to_integer() == a % b);
+    }
+}
+
+void test_rational() {
+    rational h; // harmonic number
+    for (int i = 1; i <= 30; ++i) h += rational(integer(1), integer(i));
+    assert (h == rational(integer(natural("9304682830147")), integer(natural("2329089562800"))));
+    rational t; // telescoping sum of 1/k(k+1)
+    for (int k = 1; k <= 50; ++k) t += rational(integer(1), integer(k*(k+1)));
+    assert (t == rational(integer(50), integer(51)));
+    rational a = *rational::from_string("-6/4");
+    assert (a.to_string() == "-3/2");
+    assert (a * rational(integer(2), - integer(3)) == rational(integer(1)));
+    assert (a / a == rational(integer(1)));
+    assert (a - a == rational());
+    assert (a < rational() and - a > rational());
+    assert (a.trunc() == - integer(1));
+}
+
+void test_bit_shift() {
+    natural a = natural("872346587326487287434732873677456478263487587361731672565438564387527344325");
+    for (int i = 0; i < 100; i += 7) {
+        assert ((a << i) >> i == a);
+        assert ((a << i).bit_length() == a.bit_length() + i);
+    }
+    assert (natural("4294967296").bit_length() == 33); // 2^32
+    assert (natural("4294967296").count_trailing_zeros() == 32);
+    assert (sqrt(a * a) == a);
+    assert (sqrt(a * a - natural(1)) == a - natural(1));
+}
+
+void test_divmod() {
+    natural e64 = natural("18446744073709551616"); // 2^64
+    natural a = natural("872346587326487287434732873677456478263487587361731672565438564387527344325");
+    for (natural b : { natural(1), natural(7), e64, e64 - natural(1), e64 * e64 + natural(3), natural("98765432109876543210987654321") }) {
+        auto p = natural::divmod(a, b);
+        assert (p.first * b + p.second == a);
+        assert (p.second < b);
+    }
+}
+
+void test_bigfloat() {
+    bigfloat two = bigfloat(integer(2), 256);
+    assert (sqrt(two).to_string(50) == "1.41421356237309504880168872420969807856967187537694");
+    bigfloat third_down = bigfloat::div(bigfloat(integer(1)), bigfloat(integer(3)), 10, bigfloat::round_downward);
+    bigfloat third_up   = bigfloat::div(bigfloat(integer(1)), bigfloat(integer(3)), 10, bigfloat::round_upward);
+    assert (third_down < third_up);
+    assert (third_up - third_down == bigfloat(rational(integer(1), integer(2048)))); // 1 ulp
+    assert (bigfloat(rational(integer(1), integer(3)), 10) == third_up);
+    bigfloat one = bigfloat(integer(1), 53);
+    bigfloat tiny = bigfloat(rational(integer(1), integer(natural(1) << 100)), 53);
+    assert (one + tiny == one);
+    assert (bigfloat::add(one, tiny, 53, bigfloat::round_upward) > one);
+    assert (bigfloat::sub(one, tiny, 53, bigfloat::round_downward) < one);
+    assert (bigfloat::sub(one, tiny, 53, bigfloat::round_to_nearest) == one);
+    assert (bigfloat::from_string("-2.5", 3)->trunc() == - integer(2));
+    assert (bigfloat::from_string("-2.5", 2) == bigfloat(- integer(2), 2)); // ties to even
+    assert (bigfloat::from_string("-3.5", 2) == bigfloat(- integer(4), 2));
+    assert ((*bigfloat::from_string("0.375") * bigfloat(integer(8))).to_rational() == rational(integer(3)));
+    assert (bigfloat(rational(integer(-1), integer(1000))).to_string(2) == "0.00");
+    assert (bigfloat(rational(integer(-1), integer(1024))).to_string(3) == "0.000");
+    assert (bigfloat(rational(integer(-1), integer(1024))).to_string(4) == "-0.0009");
+    assert (bigfloat(rational(integer(-1), integer(1024))).to_string(12) == "-0.000976562500");
+    assert (bigfloat::from_string("-0.0009765625") == bigfloat(rational(integer(-1), integer(1024))));
+    static_assert (not std::is_convertible<integer, bigfloat>::value, "rounds, so must be explicit");
+    static_assert (not std::is_convertible<rational, bigfloat>::value, "rounds, so must be explicit");
+    integer big = integer(natural("123456789012345678901234567890123456789"));
+    assert (bigfloat::exact(big).trunc() == big);
+    assert (bigfloat::exact(- big).precision() == 127);
+    assert (bigfloat::exact(integer()) == bigfloat());
+    static_assert (not std::is_constructible<bigfloat, int>::value, "a precision is not a value");
+    assert (bigfloat::zero(5).precision() == 5 and not bigfloat::zero(5));
+    bigfloat y = bigfloat::zero(300);
+    y += bigfloat::exact(big);
+    assert (y.trunc() == big);
+}
+
+void test_series() {
+    string pi = "3.1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679";
+    assert (series::pi(400).to_string(100) == pi);
+    assert (series::pi(400, 2).to_string(100) == pi);
+    assert (series::e(400).to_string(100) == "2.7182818284590452353602874713526624977572470936999595749669676277240766303535475945713821785251664274");
+    assert (series::log(rational(integer(2)), 400).to_string(100) == "0.6931471805599453094172321214581765680755001343602552541206800094933936219696947156058633269964186875");
+    assert (series::log(rational(integer(1), integer(2)), 400) == - series::log(rational(integer(2)), 400));
+    assert (series::log(rational(integer(1000)), 400).to_string(50) == "6.90775527898213705205397436405309262280330446588631");
+    assert (series::log(rational(integer(natural(1) << 200)), 400).to_string(50) == "138.62943611198906188344642429163531361510002687205105");
+    assert (series::log(rational(integer(1), integer(natural("1000000000000000000000000000000"))), 400).to_string(50) == "-69.07755278982137052053974364053092622803304465886318");
+    assert (series::log(rational(integer(1)), 64) == bigfloat());
+    series geometric( // 1 + 1/2 + 1/4 + ...
+        [](int) { return integer(1); },
+        [](int) { return integer(1); },
+        [](int k) { return k == 0 ? integer(1) : integer(2); });
+    assert (geometric.sum(10) == rational(integer(1023), integer(512)));
+}
+
+void test_integer_divmod() {
+    // { a, b, trunc, floor, ceil, euclid } of the quotients
+    int table[][6] = {
+        {  7,  2,  3,  3,  4,  3 },
+        { -7,  2, -3, -4, -3, -4 },
+        {  7, -2, -3, -4, -3, -3 },
+        { -7, -2,  3,  3,  4,  4 },
+        {  6, -2, -3, -3, -3, -3 },
+        {  0, -2,  0,  0,  0,  0 },
+    };
+    auto make = [](int x) { return x < 0 ? - integer(- x) : integer(x); };
+    for (auto & row : table) {
+        integer a = make(row[0]);
+        integer b = make(row[1]);
+        auto check = [&](pair<integer,integer> p, int q) {
+            assert (p.first == make(q));
+            assert (p.first * b + p.second == a);
+            assert (abs(p.second) < abs(b));
+        };
+        check(integer::divmod(a, b), row[2]);
+        check(integer::floor_divmod(a, b), row[3]);
+        check(integer::ceil_divmod(a, b), row[4]);
+        check(integer::euclidean_divmod(a, b), row[5]);
+        assert (a / b == make(row[2]));
+        integer c = a; c %= b; assert (c == a % b);
+    }
+    integer a = integer(natural("100000000000000000000000000000000"));
+    integer b = - integer(natural("100000000000000000000000000000001"));
+    assert (a + b == - integer(1));
+    assert (b - (- a) == - integer(1));
+    integer c = a; c += b; assert (c == - integer(1));
+}
+
+void test_mixed() {
+    default_random_engine engine;
+    uniform_int_distribution<uint64_t> word_dist;
+    uniform_int_distribution<int> length_dist(0, 6);
+    for (int i = 0; i < 200; ++i) {
+        natural a = natural(0);
+        for (int l = length_dist(engine); l --; ) a = a * natural(word_dist(engine)) + natural(word_dist(engine));
+        uint64_t b = word_dist(engine) >> (i % 64);
+        natural bn = natural(b);
+        assert (a + b == a + bn);
+        assert (b + a == a + bn);
+        assert (a * b == a * bn);
+        if (a >= bn) assert (a - b == a - bn);
+        assert ((a == b) == (a == bn));
+        assert ((a <  b) == (a <  bn));
+        assert ((a <= b) == (a <= bn));
+        assert ((b <  a) == (bn <  a));
+        assert ((b == a) == (bn == a));
+        if (a <= bn) assert (b - a == bn - a);
+        if (b) {
+            assert (a / b == a / bn);
+            assert (natural(a % b) == a % bn);
+            natural c = a; c %= b; assert (c == a % bn);
+        }
+        integer x = integer(true, a);
+        int64_t y = (int64_t) (b >> 1) * (i % 2 ? -1 : 1);
+        integer yn = integer(y);
+        assert (x + y == x + yn);
+        assert (x - y == x - yn);
+        assert (x * y == x * yn);
+        assert ((x < y) == (x < yn));
+        assert ((x == y) == (x == yn));
+        assert (y + x == yn + x);
+        assert (y - x == yn - x);
+        assert ((y <  x) == (yn <  x));
+        assert ((y >= x) == (yn >= x));
+        if (y) {
+            assert (x / y == x / yn);
+            assert (integer(x % y) == x % yn);
+        }
+    }
+    integer z = integer(5);
+    z -= 7; assert (z == -2);
+    z += 2; assert (z == 0 and not z);
+    z -= 0; assert (z == 0);
+    z += 0; assert (z == 0);
+    assert (natural() - 0 == natural());
+    natural w; w -= 0; assert (not w);
+    assert (integer(numeric_limits<int64_t>::min()).to_int() == numeric_limits<int64_t>::min());
+    assert (integer(numeric_limits<int64_t>::max()).to_int() == numeric_limits<int64_t>::max());
+    assert (not (integer(numeric_limits<int64_t>::max()) + 1).fits_int());
+    assert ((integer(numeric_limits<int64_t>::min()) - 1) < numeric_limits<int64_t>::min());
+    assert (natural(numeric_limits<uint64_t>::max()) + 1 == natural("18446744073709551616"));
+}
+
+void test_rns() {
+    auto basis = make_shared<rns_basis const>(1000);
+    assert (1000 < basis->modulus().bit_length());
+    natural a = natural("872346587326487287434732873677456478263487587361731672565438564387527344325");
+    natural b = natural("39402006196394479212279040100143613805079739270465446667948293404245721771497210611414266254884915640806627990306816");
+    natural c = natural("4294967295");
+    rns_natural ar(basis, a), br(basis, b), cr(basis, c);
+    assert (ar.to_natural() == a);
+    assert (rns_natural(basis).to_natural() == natural(0));
+    assert ((ar * br + cr).to_natural() == a * b + c);
+    assert ((ar * ar * ar - br).to_natural() == a * a * a - b);
+    assert ((br - ar + ar) == br);
+    assert ((cr - ar).to_natural() == basis->modulus() + c - a); // wraps around
+}
+
 int main() {
     test_ordering();
     test_operate();
@@ -133,5 +390,14 @@ int main() {
     test_mult_1();
     test_mult_2();
     test_shift();
+    test_fixed();
+    test_rational();
+    test_bit_shift();
+    test_divmod();
+    test_bigfloat();
+    test_series();
+    test_integer_divmod();
+    test_mixed();
+    test_rns();
     return 0;
 }